@@ -29,4 +29,9 @@ _write_cr3:
 	mov eax, [ebp+8]
 	mov cr3, eax
 	pop ebp
-	retn
\ No newline at end of file
+	retn
+global _invlpg
+_invlpg:
+	mov eax, [esp+4]
+	invlpg [eax]
+	retn
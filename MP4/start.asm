@@ -11,6 +11,8 @@
 [BITS 32]
 global start
 start:
+    mov [_multiboot_magic], eax     ; Keep what GRUB hands over (see
+    mov [_multiboot_info_addr], ebx ; memory_map.H), stublet uses ebx
     mov esp, _sys_stack     ; This points the stack to our new stack area
     jmp stublet
 
@@ -100,6 +102,13 @@ static_dtors_loop:
 ; Set up Low-level Interrupt Handling
 %include "irq_low.asm"
 
+; The Multiboot magic number and the address of the Multiboot information,
+; as the boot loader left them in eax and ebx.
+SECTION .data
+global _multiboot_magic, _multiboot_info_addr
+_multiboot_magic:       dd 0
+_multiboot_info_addr:   dd 0
+
 ; Here is the definition of our BSS section. Right now, we'll use
 ; it just to store the stack. Remember that a stack actually grows
 ; downwards, so we declare the size of the data before declaring
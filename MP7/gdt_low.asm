@@ -1,12 +1,12 @@
 ; This will set up our new segment registers. We need to do
 ; somethin special in order to set CS. We do what is called a
 ; far jump. A jump that includes a segment as well as an offset.
-; This is declared in C as 'extern void gdt_flush();'
+; This is declared in C as 'extern void gdt_flush(struct gdt_ptr * _gp);'
 global _gdt_flush	; Allows the C code to link to this.
-extern _gp		; Says that '_gp' is in another file
 
 _gdt_flush:
-	lgdt[_gp]	; Load the GDT with our '_gp', a special pointer
+	mov eax, [esp+4]	; the special pointer of this processor's GDT
+	lgdt [eax]	; Load the GDT with it
 	mov ax, 0x10	; 0x10 is the offset in the GDT to our data segment
 	mov ds, ax
 	mov es, ax
@@ -14,6 +14,7 @@ global _irq12
 global _irq13
 global _irq14
 global _irq15
+global _irq16
 
 ; 32: IRQ0
 _irq0:
@@ -111,6 +112,12 @@ _irq15:
     push byte 47
     jmp irq_common_stub
 
+; 48: reschedule IPI (see smp.H)
+_irq16:
+    push byte 0
+    push byte 48
+    jmp irq_common_stub
+
 extern _lowlevel_dispatch_interrupt
 
 irq_common_stub:
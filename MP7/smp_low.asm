@@ -0,0 +1,84 @@
+; File: smp_low.asm
+;
+; Start-up code of the application processors (APs).
+;
+; A startup IPI starts an AP in real mode at CS:IP = (vector * 256):0.
+; SMP::init() copies the code between _smp_trampoline_start and
+; _smp_trampoline_end to SMP_TRAMPOLINE (see smp.H) and fills in the
+; three variables at its end. The code runs at that address, not where
+; it was linked, so it reaches its own labels through TR().
+;
+; An AP switches to protected mode with a flat GDT of its own (the same
+; selectors as the kernel's), takes the next CPU number, and calls
+;
+;     smp_trampoline_entry(cpu number)
+;
+; on the top of smp_trampoline_stacks[number - 1]. All APs may run this
+; at the same time, since the startup IPIs are broadcast.
+
+SMP_TRAMPOLINE  equ 0x8000      ; must match smp.H
+SMP_MAX_CPUS    equ 8
+SMP_BOOT_STACK  equ 4096
+
+%define TR(label) (SMP_TRAMPOLINE + (label) - _smp_trampoline_start)
+
+global _smp_trampoline_start
+global _smp_trampoline_end
+global _smp_trampoline_entry
+global _smp_trampoline_stacks
+global _smp_trampoline_next
+
+[BITS 16]
+align 16
+_smp_trampoline_start:
+	cli
+	cld
+	xor	ax, ax
+	mov	ds, ax
+
+	lgdt	[TR(tr_gdtr)]
+	mov	eax, cr0
+	or	eax, 1			; PE
+	mov	cr0, eax
+
+	jmp	dword 0x08:TR(tr_protected)
+
+[BITS 32]
+tr_protected:
+	mov	ax, 0x10
+	mov	ds, ax
+	mov	es, ax
+	mov	fs, ax
+	mov	gs, ax
+	mov	ss, ax
+
+	; Claim a CPU number. The boot processor is 0, so this starts at 1.
+	mov	eax, 1
+	lock xadd [TR(_smp_trampoline_next)], eax
+	cmp	eax, SMP_MAX_CPUS
+	jae	.park			; more processors than we have room for
+
+	imul	esp, eax, SMP_BOOT_STACK
+	add	esp, [TR(_smp_trampoline_stacks)]
+	push	eax
+	call	[TR(_smp_trampoline_entry)]
+
+.park:
+	cli
+	hlt
+	jmp	.park
+
+align 8
+tr_gdt:
+	dq	0
+	dq	0x00CF9A000000FFFF	; 0x08: code, base 0, 4 GB
+	dq	0x00CF92000000FFFF	; 0x10: data, base 0, 4 GB
+tr_gdtr:
+	dw	tr_gdtr - tr_gdt - 1
+	dd	TR(tr_gdt)
+
+align 4
+_smp_trampoline_entry:	dd 0	; void entry(unsigned int cpu)
+_smp_trampoline_stacks:	dd 0	; SMP_BOOT_STACK bytes per AP
+_smp_trampoline_next:	dd 0	; next CPU number
+_smp_trampoline_end:
@@ -0,0 +1,69 @@
+; File: syscall_low.asm
+;
+; The ways between a process (ring 3) and the kernel: the two entries of
+; system calls (see syscall.H), and the way into a process to begin with.
+;
+; Both entries push the arguments of syscall_dispatch(number, arg1, arg2,
+; arg3) and call it; the C calling convention preserves EBX, ESI, EDI and
+; EBP for the process. The segment registers are not switched: the data
+; segments of the process cover all memory, like the kernel's, and are
+; only of ring 3 (the pages of the kernel are supervisor pages anyway).
+
+[BITS 32]
+
+USER_CS		equ	0x1B
+USER_DS		equ	0x23
+EFLAGS_IF	equ	0x200
+
+global _syscall_int
+global _syscall_sysenter
+global _process_enter_user
+extern _syscall_dispatch
+
+; int 0x80: a trap gate, so interrupts stay as they were in the process
+; (enabled). We are on the kernel stack of the thread, with the frame of
+; the process below us.
+_syscall_int:
+	push	edi
+	push	esi
+	push	ebx
+	push	eax
+	call	_syscall_dispatch
+	add	esp, 16
+	iret
+
+; sysenter: interrupts are off, and ESP is SYSENTER_ESP, which points at
+; esp0 in the TSS of the processor. So the first thing is to take the
+; stack of the thread from there. EDX and ECX are where to return to.
+_syscall_sysenter:
+	mov	esp, [esp]
+	push	ecx			; esp of the process
+	push	edx			; eip of the process
+	sti
+	push	edi
+	push	esi
+	push	ebx
+	push	eax
+	call	_syscall_dispatch
+	add	esp, 16
+	pop	edx
+	pop	ecx
+	sysexit				; with interrupts on, as the process runs
+
+; process_enter_user(eip, esp, arg): start running in ring 3 at eip, with
+; the stack at esp and arg in EAX. Does not return.
+_process_enter_user:
+	mov	ecx, [esp+4]
+	mov	edx, [esp+8]
+	mov	eax, [esp+12]
+	mov	bx, USER_DS
+	mov	ds, bx
+	mov	es, bx
+	mov	fs, bx
+	mov	gs, bx
+	push	dword USER_DS		; ss
+	push	edx			; esp
+	push	dword EFLAGS_IF		; eflags
+	push	dword USER_CS		; cs
+	push	ecx			; eip
+	iret
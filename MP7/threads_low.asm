@@ -8,12 +8,36 @@
 
 
 ; ----------------------------------------------------------------------
-; threads_low_switch_to(Thread * _thread)
+; threads_low_yield_to(Thread * _thread, Thread ** _current)
+; threads_low_switch_to(Thread * _thread, Thread ** _current)
 ; 
 ; If the calling entity is a thread, we save its context. 
 ; Then we load the context of the new thread, and continue executing
 ; with the new thread.
 ;
+; _current is where the processor we run on keeps its current thread
+; (see smp.H); it is read to find the thread to save, and set to the
+; new thread.
+;
+; threads_low_yield_to is for voluntary switches. They happen in a call
+; from C, so only what the C calling convention makes the callee keep
+; has to be saved: ebx, esi, edi, ebp, and esp and eip implicitly.
+; threads_low_switch_to saves everything, as an interrupt would (eflags,
+; all general-purpose and segment registers), for preemption.
+;
+; Either way, a saved thread looks the same on its stack:
+;
+;            return addr    (into C code, or _threads_low_resume_full)
+;            ebp
+;            ebx
+;            esi
+;    esp --> edi
+;
+; so that any thread can be resumed by the same four pops and a ret.
+; Thread::setup_context() builds this for a new thread. Below the return
+; address to _threads_low_resume_full, threads_low_switch_to leaves the
+; 68-byte frame (REGS in machine.H) that it restores with an iret.
+;
 ; ----------------------------------------------------------------------
 
 [BITS 32]
@@ -27,7 +51,7 @@ INTERRUPT_STATE_SIZE equ 68 ; size of exception frame on stack
 ; Save registers prior to calling a handler function.
 ; This must be kept up to date with:
 ;   - REGS (register context) struct in machine.h
-;   - setup_thread_context() in threads.c
+;   - INTERRUPT_STATE_SIZE above
 %macro save_registers 0
 	pushad
 	push	ds
@@ -47,7 +71,41 @@ INTERRUPT_STATE_SIZE equ 68 ; size of exception frame on stack
 	add	esp, 8	; skip int num and error code
 %endmacro
 
-extern _current_thread  ; defined and initialized in threads.c
+global _threads_low_yield_to
+align 16
+; this function is exported.
+_threads_low_yield_to:
+
+	mov	eax, [esp+4]	; the new thread
+	mov	edx, [esp+8]	; the current slot
+
+	push	ebp
+	push	ebx
+	push	esi
+	push	edi
+
+	; If the start-up code is giving control to the first thread, there
+	; is nothing to save: its registers are dropped with its stack.
+	mov	ecx, [edx]
+	test	ecx, ecx
+	jz	threads_low_load
+
+	; Save stack pointer in the thread context struct (at offset 0).
+	mov	[ecx+0], esp
+
+threads_low_load:
+
+	; eax: new thread, edx: current slot.
+	; Make the new thread current, switch to its stack, and return to
+	; where it was saved.
+	mov	[edx], eax
+	mov	esp, [eax+0]
+
+	pop	edi
+	pop	esi
+	pop	ebx
+	pop	ebp
+	ret
 
 
 global _threads_low_switch_to
@@ -61,17 +119,20 @@ _threads_low_switch_to:
 	; don't need to do anything with setting up and saving the current
         ; context. We simply proceed to loading the new context. 
 
-	cmp	[_current_thread], dword 0
+	mov	eax, [esp+8]
+	cmp	[eax], dword 0
 	je	.context_load_only
 
 	; Modify the stack to allow a later return via an iret instruction.
 	; We start with a stack that looks like this:
 	;
+	;            current_ptr
 	;            thread_ptr
 	;    esp --> return addr
 	;
 	; We change it to look like this:
 	;
+	;            current_ptr
 	;            thread_ptr
 	;            eflags
 	;            cs
@@ -94,36 +155,36 @@ _threads_low_switch_to:
 	; Save general purpose registers.
 	save_registers
 
-	; Save stack pointer in the thread context struct (at offset 0).
-	mov	eax, [_current_thread]
-	mov	[eax+0], esp
-
-	; Load the pointer to the new thread context into eax.
-	; We skip over the Interrupt_State struct on the stack to
-	; get the parameter.
+	; Get the parameters, which are above the Interrupt_State struct on
+	; the stack.
 	mov	eax, dword [esp+INTERRUPT_STATE_SIZE]
+	mov	edx, dword [esp+INTERRUPT_STATE_SIZE+4]
 
-	; Make the new thread current, and switch to its stack.
-	mov	[_current_thread], eax
-	mov	esp, [eax+0]
+	; Resuming the thread has to go through the iret; the callee-saved
+	; registers are in the frame already, so their slots are left as
+	; they are.
+	push	dword _threads_low_resume_full
+	sub	esp, 16
 
-	; Restore general purpose and segment registers, and clear interrupt
-	; number and error code.
-	restore_registers
+	; Save stack pointer in the thread context struct (at offset 0).
+	mov	ecx, [edx]
+	mov	[ecx+0], esp
 
-	; We'll return to the place where the thread was
-	; executing last.
-	iret
+	jmp	threads_low_load
 
 .context_load_only:
 
-	; We skipped the whole exception frame setup, and just need to 
-        ; store the thread pointer into eax.
+	; Nothing to save: just get the parameters.
         mov	eax, [esp+4]
+	mov	edx, [esp+8]
 
-	; Make the new thread current, and switch to its stack.
-	mov	[_current_thread], eax
-	mov	esp, [eax+0]
+	jmp	threads_low_load
+
+
+global _threads_low_resume_full
+align 16
+; where a thread saved by threads_low_switch_to is resumed.
+_threads_low_resume_full:
 
 	; Restore general purpose and segment registers, and clear interrupt
 	; number and error code.
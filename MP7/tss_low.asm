@@ -0,0 +1,20 @@
+; File: tss_low.asm
+;
+; Entry of the double-fault task (see tss.H).
+;
+; The processor switches to the task through the task gate of exception
+; 8, and pushes an error code (always 0) on the task's stack. The handler
+; returns if the interrupted thread can go on; iret then switches back to
+; it, since the task switch set NT. The state of the task, right after the
+; iret, is saved in its TSS, so the next double fault starts at the jmp.
+
+[BITS 32]
+
+global _double_fault_task
+extern _double_fault_handler
+
+_double_fault_task:
+	add	esp, 4			; the error code
+	call	_double_fault_handler
+	iret				; back to the interrupted task
+	jmp	_double_fault_task
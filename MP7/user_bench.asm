@@ -0,0 +1,109 @@
+; File: user_bench.asm
+;
+; A program for a process (see process.H): it times system calls through
+; int 0x80 and through sysenter, and reports the cycles to the kernel. A
+; second one checks that a process cannot take the kernel down with it.
+;
+; The kernel copies the bytes between _user_bench and _user_bench_end to
+; the address space of the process, so the code must not depend on where
+; it runs: no absolute addresses. EAX holds the argument of the process:
+; bit 0 set if the processor has sysenter.
+;
+; Calls (see syscall.H): EAX the number, EBX, ESI and EDI the arguments.
+; sysenter returns to EDX, with the stack at ECX.
+
+[BITS 32]
+
+SYS_NULL	equ	0
+SYS_WRITE	equ	2
+SYS_EXIT	equ	3
+SYS_REPORT	equ	8		; kernel.C: (path, cycles, rounds)
+
+ROUNDS		equ	10000
+
+global _user_bench
+global _user_bench_end
+
+_user_bench:
+	mov	ebp, eax		; keep the argument
+
+	; -- hello, through the kernel: our own address, for the string
+	call	.here
+.here:	pop	ebx
+	add	ebx, hello - .here
+	mov	esi, hello_len
+	mov	eax, SYS_WRITE
+	int	0x80
+
+	; -- int 0x80
+	rdtsc
+	mov	ebx, eax
+	mov	edi, ROUNDS
+.trap:	mov	eax, SYS_NULL
+	int	0x80
+	dec	edi
+	jnz	.trap
+	rdtsc
+	sub	eax, ebx		; the low 32 bits are enough
+	mov	esi, eax
+	mov	ebx, 0
+	mov	edi, ROUNDS
+	mov	eax, SYS_REPORT
+	int	0x80
+
+	; -- sysenter
+	test	ebp, 1
+	jz	.done
+	call	.pc
+.pc:	pop	ebp
+	add	ebp, .back - .pc	; where sysexit returns to
+	rdtsc
+	mov	ebx, eax
+	mov	edi, ROUNDS
+.fast:	mov	eax, SYS_NULL
+	mov	edx, ebp
+	mov	ecx, esp
+	sysenter
+.back:	dec	edi
+	jnz	.fast
+	rdtsc
+	sub	eax, ebx
+	mov	esi, eax
+	mov	ebx, 1
+	mov	edi, ROUNDS
+	mov	eax, SYS_REPORT
+	int	0x80
+
+.done:	mov	ebx, 0
+	mov	eax, SYS_EXIT
+	int	0x80
+	jmp	.done			; not reached
+
+hello:	db	"USER: hello from ring 3", 10
+hello_len equ	$ - hello
+
+_user_bench_end:
+
+; A second program, which the kernel expects to end for it: it hands the
+; kernel a buffer in the unmapped guard page below it, which SYS_WRITE must
+; refuse, and then writes to that page itself, which ends the process.
+
+USER_BASE	equ	0x40000000	; page_table.H: the guard page below the program
+
+global _user_fault
+global _user_fault_end
+
+_user_fault:
+	mov	ebx, USER_BASE
+	mov	esi, 16
+	mov	eax, SYS_WRITE
+	int	0x80
+	cmp	eax, -1
+	jne	.wrong
+	mov	dword [USER_BASE], 0	; ends the process
+.wrong:	mov	ebx, 1			; the kernel let us through
+	mov	eax, SYS_EXIT
+	int	0x80
+	jmp	.wrong			; not reached
+
+_user_fault_end:
@@ -0,0 +1,53 @@
+; File: user_hello.asm
+;
+; A program for Process::exec() (see process.H): an ELF executable,
+; linked by user.ld to run at the bottom of the user part of an address
+; space. Unlike user_bench.asm it can use absolute addresses.
+;
+; It says hello, touches one page of a large .bss table, and exits with
+; the value of a variable in .data. The kernel reads the pages of the
+; program from the file as they are touched (see elf.H): the text, the
+; data and one page of the table; the other pages of the table are
+; never mapped.
+;
+; Calls (see syscall.H): EAX the number, EBX, ESI and EDI the arguments.
+
+[BITS 32]
+
+SYS_WRITE	equ	2
+SYS_EXIT	equ	3
+
+TABLE_SIZE	equ	16 * 4096
+
+global _start
+
+section .text
+
+_start:
+	mov	ebx, hello
+	mov	esi, hello_len
+	mov	eax, SYS_WRITE
+	int	0x80
+
+	; -- one page of the table, the last one: zeros until we write
+	cmp	dword [table + TABLE_SIZE - 4], 0
+	jne	.bad
+	mov	eax, [status]
+	mov	[table + TABLE_SIZE - 4], eax
+
+	mov	ebx, [table + TABLE_SIZE - 4]
+	jmp	.exit
+.bad:	mov	ebx, 1
+.exit:	mov	eax, SYS_EXIT
+	int	0x80
+	jmp	.exit			; not reached
+
+section .data
+
+status:	dd	42
+hello:	db	"USER: hello from an ELF file", 10
+hello_len equ	$ - hello
+
+section .bss
+
+table:	resb	TABLE_SIZE
@@ -0,0 +1,12 @@
+; File: user_image.asm
+;
+; The executable user_hello.elf, as bytes in the kernel: there is no other
+; way to get it onto the disk, which is formatted at boot. The kernel
+; writes it to a file before it runs it (see kernel.C).
+
+global _user_hello_elf
+global _user_hello_elf_end
+
+_user_hello_elf:
+	incbin	"user_hello.elf"
+_user_hello_elf_end: